@@ -9,7 +9,10 @@
 #define gens 10
 
 bool cells[size][size];
-bool new_cells[size][size];
+
+bool row1[size];
+bool row2[size];
+bool first_row[size];
 
 void randomizeCells() {
   for (int x = 0; x < size; ++x) {
@@ -28,26 +31,40 @@ void printCells() {
   }
 }
 
-void nextGeneration() {
-  for (int x = 0; x < size; ++x) {
-    for (int y = 0; y < size; ++y) {
-      int neighbors = 0;
-
-      for (int dx = -1; dx <= 1; ++dx) {
-        for (int dy = -1; dy <= 1; ++dy) {
-          int nx = (size + x + dx) % size;
-          int ny = (size + y + dy) % size;
-          if ((dx != 0 || dy != 0) && cells[nx][ny]) {
-            neighbors++;
-          }
+void nextRow(const bool *above, const bool *here, const bool *below, bool *out) {
+  const bool *neighborhood[3] = {above, here, below};
+
+  for (int y = 0; y < size; ++y) {
+    int neighbors = 0;
+
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        int ny = (size + y + dy) % size;
+        if ((dx != 0 || dy != 0) && neighborhood[dx + 1][ny]) {
+          neighbors++;
         }
       }
-
-      new_cells[x][y] = neighbors == 3 || (neighbors == 2 && cells[x][y]);
     }
+
+    out[y] = neighbors == 3 || (neighbors == 2 && here[y]);
   }
+}
+
+void nextGeneration() {
+  bool *above = row1;
+  bool *here = row2;
+  memcpy(above, cells[size - 1], sizeof row1);
+  memcpy(first_row, cells[0], sizeof first_row);
 
-  memcpy(cells, new_cells, sizeof cells);
+  for (int x = 0; x < size; ++x) {
+    memcpy(here, cells[x], sizeof row2);
+    const bool *below = x + 1 < size ? cells[x + 1] : first_row;
+    nextRow(above, here, below, cells[x]);
+
+    bool *swap = above;
+    above = here;
+    here = swap;
+  }
 }
 
 int main(void) {
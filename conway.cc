@@ -10,10 +10,13 @@ constexpr uint64_t total_cells = rows * rows;
 constexpr uint64_t gens = target_load / total_cells;
 constexpr uint64_t total_cell_updates = gens * total_cells;
 
-uint64_t board1[rows][cols];
-uint64_t board2[rows][cols];
-auto cells = board1;
-auto buffer = board2;
+uint64_t cells[rows][cols];
+
+uint64_t row1[cols];
+uint64_t row2[cols];
+uint64_t first_row[cols];
+auto above = row1;
+auto here = row2;
 
 void randomizeCells() {
   for (int y = 0; y < rows; ++y) {
@@ -36,46 +39,55 @@ void printCells() {
   }
 }
 
-void nextGeneration() {
-  for (int y = 0; y < rows; ++y) {
-    for (int x = 0; x < cols; ++x) {
-      uint64_t b1 = 0, b2 = 0, b4 = 0;
-
-      for (int dy = -1; dy <= 1; ++dy) {
-        for (int dx = -1; dx <= 1; ++dx) {
-          if (dx != 0 || dy != 0) {
-            int ny = (rows + y + dy) % rows;
-            int nx = (cols + x + dx) % cols;
-            uint64_t alive = cells[ny][x];
-            uint64_t last = cells[ny][nx];
-
-            switch (dx) {
-            case 1:
-              alive <<= 1;
-              last >>= 63;
-              alive |= last;
-              break;
-            case -1:
-              alive >>= 1;
-              last <<= 63;
-              alive |= last;
-              break;
-            }
-
-            uint64_t c2 = alive & b1;
-            uint64_t c4 = c2 & b2;
-            b1 ^= alive;
-            b2 ^= c2;
-            b4 |= c4;
+void nextRow(const uint64_t *above, const uint64_t *here, const uint64_t *below, uint64_t *out) {
+  const uint64_t *neighborhood[3] = {above, here, below};
+
+  for (int x = 0; x < cols; ++x) {
+    uint64_t b1 = 0, b2 = 0, b4 = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (dx != 0 || dy != 0) {
+          int nx = (cols + x + dx) % cols;
+          uint64_t alive = neighborhood[dy + 1][x];
+          uint64_t last = neighborhood[dy + 1][nx];
+
+          switch (dx) {
+          case 1:
+            alive <<= 1;
+            last >>= 63;
+            alive |= last;
+            break;
+          case -1:
+            alive >>= 1;
+            last <<= 63;
+            alive |= last;
+            break;
           }
+
+          uint64_t c2 = alive & b1;
+          uint64_t c4 = c2 & b2;
+          b1 ^= alive;
+          b2 ^= c2;
+          b4 |= c4;
         }
       }
-
-      buffer[y][x] = b2 & (b1 | cells[y][x]) & ~b4;
     }
+
+    out[x] = b2 & (b1 | here[x]) & ~b4;
   }
+}
 
-  std::swap(cells, buffer);
+void nextGeneration() {
+  std::copy(cells[rows - 1], cells[rows - 1] + cols, above);
+  std::copy(cells[0], cells[0] + cols, first_row);
+
+  for (int y = 0; y < rows; ++y) {
+    std::copy(cells[y], cells[y] + cols, here);
+    const uint64_t *below = y + 1 < rows ? cells[y + 1] : first_row;
+    nextRow(above, here, below, cells[y]);
+    std::swap(above, here);
+  }
 }
 
 int main(void) {
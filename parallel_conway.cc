@@ -9,10 +9,15 @@ constexpr int gens = 5;
 constexpr int threads = 2;
 constexpr int batch = rows / threads;
 
-uint64_t board1[rows][cols];
-uint64_t board2[rows][cols];
-auto cells = board1;
-auto buffer = board2;
+uint64_t cells[rows][cols];
+
+// The board is stepped in place. Each thread keeps the original contents of
+// the rows it has already overwritten in a small rolling buffer, and the rows
+// on either edge of every band are saved up front since the neighbouring
+// bands overwrite them concurrently.
+uint64_t rolling[threads][2][cols];
+uint64_t band_first[threads][cols];
+uint64_t band_last[threads][cols];
 
 void randomizeCells() {
   for (int x = 0; x < rows; ++x) {
@@ -35,49 +40,67 @@ void printCells() {
   }
 }
 
+void nextRow(const uint64_t *above, const uint64_t *here, const uint64_t *below, uint64_t *out) {
+  const uint64_t *neighborhood[3] = {above, here, below};
+
+  for (int x = 0; x < cols; ++x) {
+    uint64_t b1 = 0, b2 = 0, b4 = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (dx != 0 || dy != 0) {
+          int nx = (cols + x + dx) % cols;
+          uint64_t alive = neighborhood[dy + 1][x];
+          uint64_t last = neighborhood[dy + 1][nx];
+
+          switch (dx) {
+          case 1:
+            alive <<= 1;
+            last >>= 63;
+            alive |= last;
+            break;
+          case -1:
+            alive >>= 1;
+            last <<= 63;
+            alive |= last;
+            break;
+          }
+
+          uint64_t c2 = alive & b1;
+          uint64_t c4 = c2 & b2;
+          b1 ^= alive;
+          b2 ^= c2;
+          b4 |= c4;
+        }
+      }
+    }
+
+    out[x] = b2 & (b1 | here[x]) & ~b4;
+  }
+}
+
 void nextGeneration() {
   ctpl::thread_pool p(threads);
   std::vector<std::future<void>> results(threads);
 
   for (int i = 0; i < threads; i++) {
     int row_start = i * batch;
-    results[i] = p.push([row_start](int){ 
-      for (int y = row_start; y < row_start + batch; ++y) {
-        for (int x = 0; x < cols; ++x) {
-          uint64_t b1 = 0, b2 = 0, b4 = 0;
-
-          for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
-              if (dx != 0 || dy != 0) {
-                int ny = (rows + y + dy) % rows;
-                int nx = (cols + x + dx) % cols;
-                uint64_t alive = cells[ny][x];
-                uint64_t last = cells[ny][nx];
-
-                switch (dx) {
-                case 1:
-                  alive <<= 1;
-                  last >>= 63;
-                  alive |= last;
-                  break;
-                case -1:
-                  alive >>= 1;
-                  last <<= 63;
-                  alive |= last;
-                  break;
-                }
-
-                uint64_t c2 = alive & b1;
-                uint64_t c4 = c2 & b2;
-                b1 ^= alive;
-                b2 ^= c2;
-                b4 |= c4;
-              }
-            }
-          }
+    std::copy(cells[row_start], cells[row_start] + cols, band_first[i]);
+    std::copy(cells[row_start + batch - 1], cells[row_start + batch - 1] + cols, band_last[i]);
+  }
 
-          buffer[y][x] = b2 & (b1 | cells[y][x]) & !b4;
-        }
+  for (int i = 0; i < threads; i++) {
+    int row_start = i * batch;
+    results[i] = p.push([i, row_start](int){
+      uint64_t *above = rolling[i][0];
+      uint64_t *here = rolling[i][1];
+      std::copy(band_last[(threads + i - 1) % threads], band_last[(threads + i - 1) % threads] + cols, above);
+
+      for (int y = row_start; y < row_start + batch; ++y) {
+        std::copy(cells[y], cells[y] + cols, here);
+        const uint64_t *below = y + 1 < row_start + batch ? cells[y + 1] : band_first[(i + 1) % threads];
+        nextRow(above, here, below, cells[y]);
+        std::swap(above, here);
       }
     });
   }
@@ -86,8 +109,6 @@ void nextGeneration() {
   for (int i = 0; i < threads; ++i) {
     results[i].get();
   }
-
-  std::swap(cells, buffer);
 }
 
 int main(void) {
@@ -0,0 +1,543 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include "ctpl_stl.h"
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+constexpr int stripes = 64;
+constexpr unsigned parallel_depth = 6;
+constexpr auto split_after = std::chrono::microseconds(50);
+constexpr int expansions = 2000;
+constexpr int start_depth = 4;
+constexpr int random_depth = 10;
+constexpr int thread_counts[] = {1, 2, 4, 8};
+constexpr int dense_rows = 1 << 8;
+constexpr int dense_cols = dense_rows / 64;
+constexpr uint64_t fast_forward = 1000000000000;
+
+struct Node {
+  Node *nw, *ne, *sw, *se;
+  bool alive;
+  unsigned depth;
+  // Memo for nextInner(). Threads racing on the same node may both compute
+  // it, but they arrive at the same canonical node so either store is fine.
+  std::atomic<Node *> next;
+
+  Node(Node *nw, Node *ne, Node *sw, Node *se, bool alive, unsigned depth)
+    : nw(nw), ne(ne), sw(sw), se(se), alive(alive), depth(depth), next(nullptr) {}
+
+  Node *center();
+  Node *north();
+  Node *south();
+  Node *west();
+  Node *east();
+  Node *nextInner();
+  Node *nextStep(unsigned shift);
+  Node *expand2x();
+};
+
+Node DEAD(nullptr, nullptr, nullptr, nullptr, false, 0);
+Node LIVE(nullptr, nullptr, nullptr, nullptr, true, 0);
+
+using Quad = std::array<Node *, 4>;
+
+struct QuadHash {
+  size_t operator()(const Quad &quad) const {
+    uint64_t hash = 0;
+    for (Node *node : quad) {
+      hash = (hash ^ reinterpret_cast<uintptr_t>(node)) * 0x9e3779b97f4a7c15;
+    }
+    return hash ^ (hash >> 32);
+  }
+};
+
+// The hash-consing table is split into stripes, each behind its own lock, so
+// threads building different nodes rarely contend. Nodes are never freed
+// until the whole table is cleared.
+struct Stripe {
+  std::mutex mutex;
+  std::unordered_map<Quad, Node *, QuadHash> nodes;
+  std::deque<Node> storage;
+};
+
+// Results of nextStep() for steps shorter than nextInner()'s, keyed by node
+// and step size and striped the same way as the node table.
+using Step = std::pair<Node *, unsigned>;
+
+struct StepHash {
+  size_t operator()(const Step &step) const {
+    return QuadHash()({step.first, reinterpret_cast<Node *>(uintptr_t(step.second)), nullptr, nullptr});
+  }
+};
+
+struct StepStripe {
+  std::mutex mutex;
+  std::unordered_map<Step, Node *, StepHash> results;
+};
+
+Stripe memo[stripes];
+StepStripe step_memo[stripes];
+std::mutex empty_mutex;
+std::vector<Node *> empty_memo = {&DEAD};
+ctpl::thread_pool *pool;
+uint64_t cells[dense_rows][dense_cols];
+
+Node *NodeFrom(Node *nw, Node *ne, Node *sw, Node *se) {
+  Quad quad = {nw, ne, sw, se};
+  Stripe &stripe = memo[QuadHash()(quad) % stripes];
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+
+  auto found = stripe.nodes.find(quad);
+  if (found != stripe.nodes.end()) {
+    return found->second;
+  }
+  stripe.storage.emplace_back(nw, ne, sw, se, false, nw->depth + 1);
+  Node *node = &stripe.storage.back();
+  stripe.nodes.emplace(quad, node);
+  return node;
+}
+
+size_t memoSize() {
+  size_t size = 0;
+  for (Stripe &stripe : memo) {
+    size += stripe.nodes.size();
+  }
+  return size;
+}
+
+void clearMemo() {
+  for (Stripe &stripe : memo) {
+    stripe.nodes.clear();
+    stripe.storage.clear();
+  }
+  for (StepStripe &stripe : step_memo) {
+    stripe.results.clear();
+  }
+  empty_memo.resize(1);
+}
+
+Node *Node::center() { return NodeFrom(nw->se, ne->sw, sw->ne, se->nw); }
+Node *Node::north()  { return NodeFrom(nw->ne, ne->nw, nw->se, ne->sw); }
+Node *Node::south()  { return NodeFrom(sw->ne, se->nw, sw->se, se->sw); }
+Node *Node::west()   { return NodeFrom(nw->sw, nw->se, sw->nw, sw->ne); }
+Node *Node::east()   { return NodeFrom(ne->sw, ne->se, se->nw, se->ne); }
+
+Node *lives(std::array<Node *, 9> cells) {
+  bool alive = cells[4]->alive;
+  cells[4] = &DEAD;
+  int neighbors = 0;
+  for (Node *cell : cells) {
+    if (cell->alive) {
+      neighbors++;
+    }
+  }
+  return neighbors == 3 || (neighbors == 2 && alive) ? &LIVE : &DEAD;
+}
+
+// A set of jobs forked by forEach(). Each job is run by whichever thread
+// claims it first. While a job runs, the fork it starts in turn is linked from
+// children, so threads waiting on this fork can find work further down.
+struct Fork {
+  int count;
+  int indices[9];
+  std::function<void(int)> job;
+  std::atomic<bool> claimed[9];
+  std::atomic<int> remaining;
+  std::shared_ptr<Fork> children[9];
+};
+
+// The fork and job this thread is running, if any.
+thread_local Fork *running_fork = nullptr;
+thread_local int running_job = 0;
+
+bool runJob(Fork *fork, int i) {
+  if (fork->claimed[i].exchange(true)) {
+    return false;
+  }
+  Fork *outer_fork = running_fork;
+  int outer_job = running_job;
+  running_fork = fork;
+  running_job = i;
+  fork->job(fork->indices[i]);
+  running_fork = outer_fork;
+  running_job = outer_job;
+  fork->remaining.fetch_sub(1);
+  return true;
+}
+
+// Runs one unclaimed job from fork or from the forks nested under its jobs.
+// Everything found this way lies below the waiting thread's own node, so
+// helping only ever nests strictly smaller subtrees on its stack.
+bool helpWith(Fork *fork) {
+  for (int i = 0; i < fork->count; ++i) {
+    if (!fork->claimed[i].load() && runJob(fork, i)) {
+      return true;
+    }
+  }
+  for (int i = 0; i < fork->count; ++i) {
+    std::shared_ptr<Fork> child = std::atomic_load(&fork->children[i]);
+    if (child && helpWith(child.get())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Runs job(0) .. job(count - 1), where known(i) says job i is a memo hit.
+// Memo hits always run inline, and so does everything at or below
+// parallel_depth or when the pool has no workers. The other jobs also run
+// inline until split_after has passed, so the many calls that only find
+// cheap work never touch the pool. Whatever is left after that is offered to
+// the pool, and while this thread waits for the jobs others claimed it helps
+// with their subtrees.
+template <typename F, typename K>
+void forEach(int count, unsigned depth, F job, K known) {
+  bool parallel = pool->size() > 0 && depth > parallel_depth;
+  auto start = std::chrono::steady_clock::now();
+  int indices[9];
+  int forked = 0;
+  for (int i = 0; i < count; ++i) {
+    if (!parallel || known(i)) {
+      job(i);
+    } else {
+      indices[forked++] = i;
+    }
+  }
+
+  int next = 0;
+  while (next < forked && (forked - next < 2 || std::chrono::steady_clock::now() - start < split_after)) {
+    job(indices[next++]);
+  }
+  if (next == forked) {
+    return;
+  }
+
+  // Queued copies may outlive this call, by which point every job has been
+  // claimed and they only touch the shared flags.
+  auto fork = std::make_shared<Fork>();
+  fork->count = forked - next;
+  std::copy(indices + next, indices + forked, fork->indices);
+  fork->job = [&job](int i){ job(i); };
+  for (int i = 0; i < fork->count; ++i) {
+    fork->claimed[i] = false;
+  }
+  fork->remaining = fork->count;
+  Fork *parent = running_fork;
+  int parent_job = running_job;
+  if (parent) {
+    std::atomic_store(&parent->children[parent_job], fork);
+  }
+
+  for (int i = 1; i < fork->count; ++i) {
+    pool->push([fork, i](int){ runJob(fork.get(), i); });
+  }
+  for (int i = 0; i < fork->count; ++i) {
+    runJob(fork.get(), i);
+  }
+  while (fork->remaining.load() != 0) {
+    if (!helpWith(fork.get())) {
+      std::this_thread::yield();
+    }
+  }
+
+  if (parent) {
+    std::atomic_store(&parent->children[parent_job], std::shared_ptr<Fork>());
+  }
+}
+
+// Whether nextStep(shift) has already been worked out for node.
+bool stepKnown(Node *node, unsigned shift) {
+  if (shift + 2 == node->depth) {
+    return node->next.load() != nullptr;
+  }
+  Step step = {node, shift};
+  StepStripe &stripe = step_memo[StepHash()(step) % stripes];
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  return stripe.results.count(step) != 0;
+}
+
+// Calculate the center() 1<<(depth-2) generations into the future!
+Node *Node::nextInner() {
+  Node *result = next.load(std::memory_order_acquire);
+  if (result) {
+    return result;
+  }
+
+  if (depth == 2) {
+    result = NodeFrom(
+      lives({nw->nw, nw->ne, ne->nw, nw->sw, nw->se, ne->sw, sw->nw, sw->ne, se->nw}),
+      lives({nw->ne, ne->nw, ne->ne, nw->se, ne->sw, ne->se, sw->ne, se->nw, se->ne}),
+      lives({nw->sw, nw->se, ne->sw, sw->nw, sw->ne, se->nw, sw->sw, sw->se, se->sw}),
+      lives({nw->se, ne->sw, ne->se, sw->ne, se->nw, se->ne, sw->se, se->sw, se->se})
+    );
+  } else {
+    // The nine overlapping sub-squares and then the four quadrants built from
+    // their results are independent of each other.
+    Node *parts[9] = {nw, north(), ne, west(), center(), east(), sw, south(), se};
+    Node *steps[9];
+    forEach(9, depth, [&](int i){ steps[i] = parts[i]->nextInner(); },
+            [&](int i){ return parts[i]->next.load() != nullptr; });
+
+    Node *quads[4] = {
+      NodeFrom(steps[0], steps[1], steps[3], steps[4]),
+      NodeFrom(steps[1], steps[2], steps[4], steps[5]),
+      NodeFrom(steps[3], steps[4], steps[6], steps[7]),
+      NodeFrom(steps[4], steps[5], steps[7], steps[8]),
+    };
+    Node *results[4];
+    forEach(4, depth, [&](int i){ results[i] = quads[i]->nextInner(); },
+            [&](int i){ return quads[i]->next.load() != nullptr; });
+
+    result = NodeFrom(results[0], results[1], results[2], results[3]);
+  }
+
+  next.store(result, std::memory_order_release);
+  return result;
+}
+
+// Calculate the center() 1<<shift generations into the future, for any shift
+// up to depth-2. Shorter steps take the centers of the nine sub-squares
+// without advancing them and only advance the four quadrants built from them.
+Node *Node::nextStep(unsigned shift) {
+  if (shift + 2 == depth) {
+    return nextInner();
+  }
+
+  Step step = {this, shift};
+  StepStripe &stripe = step_memo[StepHash()(step) % stripes];
+  {
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto found = stripe.results.find(step);
+    if (found != stripe.results.end()) {
+      return found->second;
+    }
+  }
+
+  Node *parts[9] = {nw, north(), ne, west(), center(), east(), sw, south(), se};
+  Node *centers[9];
+  for (int i = 0; i < 9; ++i) {
+    centers[i] = parts[i]->center();
+  }
+
+  Node *quads[4] = {
+    NodeFrom(centers[0], centers[1], centers[3], centers[4]),
+    NodeFrom(centers[1], centers[2], centers[4], centers[5]),
+    NodeFrom(centers[3], centers[4], centers[6], centers[7]),
+    NodeFrom(centers[4], centers[5], centers[7], centers[8]),
+  };
+  Node *results[4];
+  forEach(4, depth, [&](int i){ results[i] = quads[i]->nextStep(shift); },
+          [&](int i){ return stepKnown(quads[i], shift); });
+  Node *result = NodeFrom(results[0], results[1], results[2], results[3]);
+
+  std::lock_guard<std::mutex> lock(stripe.mutex);
+  stripe.results.emplace(step, result);
+  return result;
+}
+
+Node *EmptyOfDepth(unsigned d) {
+  std::lock_guard<std::mutex> lock(empty_mutex);
+  while (empty_memo.size() <= d) {
+    Node *child = empty_memo.back();
+    empty_memo.push_back(NodeFrom(child, child, child, child));
+  }
+  return empty_memo[d];
+}
+
+// Propagate node out by 1<<(depth-1) generations to double the size and thus, overall time!
+Node *Node::expand2x() {
+  Node *e = EmptyOfDepth(depth);
+  Node *corners[4] = {
+    NodeFrom(e, e, e, this),
+    NodeFrom(e, e, this, e),
+    NodeFrom(e, this, e, e),
+    NodeFrom(this, e, e, e),
+  };
+  Node *results[4];
+  forEach(4, depth + 1, [&](int i){ results[i] = corners[i]->nextInner(); },
+          [&](int i){ return corners[i]->next.load() != nullptr; });
+  return NodeFrom(results[0], results[1], results[2], results[3]);
+}
+
+// Surround node with empty space, doubling its size around the same center.
+Node *Pad(Node *n) {
+  Node *e = EmptyOfDepth(n->depth - 1);
+  return NodeFrom(
+    NodeFrom(e, e, e, n->nw),
+    NodeFrom(e, e, n->ne, e),
+    NodeFrom(e, n->sw, e, e),
+    NodeFrom(n->se, e, e, e)
+  );
+}
+
+// Halve node around the same center for as long as only empty space is lost.
+Node *Crop(Node *n) {
+  while (n->depth > 3) {
+    Node *e = EmptyOfDepth(n->depth - 2);
+    if (n->nw->nw != e || n->nw->ne != e || n->nw->sw != e ||
+        n->ne->nw != e || n->ne->ne != e || n->ne->se != e ||
+        n->sw->nw != e || n->sw->sw != e || n->sw->se != e ||
+        n->se->ne != e || n->se->sw != e || n->se->se != e) {
+      break;
+    }
+    n = n->center();
+  }
+  return n;
+}
+
+// Advance board by any number of generations, one power-of-two jump for each
+// set bit. The board is a window onto an infinite dead plane that stays
+// centered on the same point and grows as far as the pattern spreads: each
+// jump of 1<<shift first pads it so that the pattern is at least that many
+// cells away from the edge of the center() that the jump returns.
+Node *Advance(Node *board, uint64_t gens) {
+  for (unsigned shift = 0; gens != 0; ++shift, gens >>= 1) {
+    if (gens & 1) {
+      unsigned depth = std::max(board->depth + 2, shift + 3);
+      while (board->depth < depth) {
+        board = Pad(board);
+      }
+      board = Crop(board->nextStep(shift));
+    }
+  }
+  return board;
+}
+
+Node *fromCells(const uint64_t *cells, int cols, int y, int x, unsigned depth) {
+  if (depth == 0) {
+    return (cells[y * cols + x / 64] >> (63 - x % 64)) & 1 ? &LIVE : &DEAD;
+  }
+  if (depth == 6) {
+    uint64_t any = 0;
+    for (int r = y; r < y + 64; ++r) {
+      any |= cells[r * cols + x / 64];
+    }
+    if (any == 0) {
+      return EmptyOfDepth(depth);
+    }
+  }
+  int half = 1 << (depth - 1);
+  return NodeFrom(
+    fromCells(cells, cols, y, x, depth - 1),
+    fromCells(cells, cols, y, x + half, depth - 1),
+    fromCells(cells, cols, y + half, x, depth - 1),
+    fromCells(cells, cols, y + half, x + half, depth - 1)
+  );
+}
+
+// Import a bit-packed rows x rows board laid out like conway.cc's, with
+// rows / 64 words per row and the leftmost cell in the top bit.
+Node *FromCells(const uint64_t *cells, int rows) {
+  return fromCells(cells, rows / 64, 0, 0, __builtin_ctz(rows));
+}
+
+void toCells(Node *n, uint64_t *cells, int cols, int y, int x) {
+  if (n == EmptyOfDepth(n->depth)) {
+    return;
+  }
+  if (n->depth == 0) {
+    cells[y * cols + x / 64] |= uint64_t(1) << (63 - x % 64);
+    return;
+  }
+  int half = 1 << (n->depth - 1);
+  toCells(n->nw, cells, cols, y, x);
+  toCells(n->ne, cells, cols, y, x + half);
+  toCells(n->sw, cells, cols, y + half, x);
+  toCells(n->se, cells, cols, y + half, x + half);
+}
+
+// Export the rows x rows square around the board's center into a bit-packed
+// board laid out like conway.cc's. Anything the pattern has sent beyond that
+// square is dropped, since the dense engines wrap around at their edges
+// where HashLife does not.
+void ToCells(Node *board, uint64_t *cells, int rows) {
+  unsigned depth = __builtin_ctz(rows);
+  while (board->depth < depth) {
+    board = Pad(board);
+  }
+  while (board->depth > depth) {
+    board = board->center();
+  }
+  std::fill(cells, cells + rows * (rows / 64), 0);
+  toCells(board, cells, rows / 64, 0, 0);
+}
+
+Node *RandomOfDepth(unsigned d) {
+  if (d == 0) {
+    return rand() & 1 ? &LIVE : &DEAD;
+  }
+  Node *nw = RandomOfDepth(d - 1);
+  Node *ne = RandomOfDepth(d - 1);
+  Node *sw = RandomOfDepth(d - 1);
+  Node *se = RandomOfDepth(d - 1);
+  return NodeFrom(nw, ne, sw, se);
+}
+
+template <typename F>
+float timeSeconds(F run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<float>(stop - start).count();
+}
+
+int main(void) {
+  for (int threads : thread_counts) {
+    // The calling thread works through the queue too, so it counts as one.
+    ctpl::thread_pool p(threads - 1);
+    pool = &p;
+
+    clearMemo();
+    srand(1);
+    Node *board = RandomOfDepth(start_depth);
+    float expand_seconds = timeSeconds([&]{
+      for (int i = 0; i < expansions; ++i) {
+        board = board->expand2x();
+      }
+    });
+    size_t expand_nodes = memoSize();
+
+    clearMemo();
+    srand(1);
+    board = RandomOfDepth(random_depth);
+    float random_seconds = timeSeconds([&]{ board->nextInner(); });
+
+    std::cout << "Threads: " << threads << std::endl;
+    std::cout << "  " << expansions << " doublings: " << expand_seconds << " seconds, "
+              << expand_nodes << " nodes" << std::endl;
+    std::cout << "  Random depth " << random_depth << " start, " << (1 << (random_depth - 2))
+              << " generations: " << random_seconds << " seconds, " << memoSize() << " nodes" << std::endl;
+  }
+
+  // Hand an R-pentomino on a dense board to HashLife, fast-forward it and
+  // bring the result back to a dense board.
+  int mid = dense_rows / 2;
+  cells[mid - 1][mid / 64] = uint64_t(0b011) << 61;
+  cells[mid][mid / 64] = uint64_t(0b110) << 61;
+  cells[mid + 1][mid / 64] = uint64_t(0b010) << 61;
+
+  ctpl::thread_pool p(thread_counts[std::size(thread_counts) - 1] - 1);
+  pool = &p;
+  clearMemo();
+  Node *board = FromCells(&cells[0][0], dense_rows);
+  float seconds = timeSeconds([&]{ board = Advance(board, fast_forward); });
+  ToCells(board, &cells[0][0], dense_rows);
+
+  uint64_t live = 0;
+  for (auto &row : cells) {
+    for (uint64_t word : row) {
+      live += __builtin_popcountll(word);
+    }
+  }
+  std::cout << "Fast-forward to generation " << fast_forward << ": " << seconds << " seconds, "
+            << memoSize() << " nodes, " << live << " live cells in the "
+            << dense_rows << "x" << dense_rows << " window" << std::endl;
+
+  return 0;
+}
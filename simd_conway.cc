@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <ctime>
 #include <iostream>
 #include "immintrin.h" // for AVX
@@ -8,7 +9,15 @@ constexpr int gens = 100;
 __m256i all_on = _mm256_set1_epi8(0x11);
 
 alignas(32) __m256i cells[rows][cols];
-alignas(32) __m256i neighbors[rows][cols];
+
+alignas(32) __m256i row1[cols];
+alignas(32) __m256i row2[cols];
+alignas(32) __m256i first_row[cols];
+alignas(32) __m256i counts[cols];
+auto above = row1;
+auto here = row2;
+
+void rowNeighbors(const __m256i *above, const __m256i *here, const __m256i *below, __m256i *out);
 
 void randomizeCells() {
   for (int x = 0; x < rows; ++x) {
@@ -30,7 +39,8 @@ void printCells() {
   int height = 19;
   for (int x = 0; x < rows && x < height; ++x) {
     uint64_t buffer[4];
-    _mm256_store_si256((__m256i *)&buffer, neighbors[x][0]);
+    rowNeighbors(cells[(rows + x - 1) % rows], cells[x], cells[(x + 1) % rows], counts);
+    _mm256_store_si256((__m256i *)&buffer, counts[0]);
 
     for (int i = 0; i < 4; ++i) {
       for (int y = 0; y < 16; ++y) {
@@ -72,61 +82,69 @@ __m256i next(__m256i alive, __m256i neighbors) {
   return _mm256_andnot_si256(b4, _mm256_and_si256(b2, _mm256_or_si256(b1, alive)));
 }
 
-void updateCells() {
-  for (int x = 0; x < rows; ++x) {
-    for (int y = 0; y < cols; ++y) {
-      cells[x][y] = next(cells[x][y], neighbors[x][y]);
+void rowNeighbors(const __m256i *above, const __m256i *here, const __m256i *below, __m256i *out) {
+  const __m256i *neighborhood[3] = {above, here, below};
+
+  for (int y = 0; y < cols; ++y) {
+    out[y] = _mm256_setzero_si256();
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        if (dx != 0 || dy != 0) {
+          int ny = (cols + y + dy) % cols;
+          __m256i alive = neighborhood[dx + 1][y];
+          __m256i last = neighborhood[dx + 1][ny];
+          __m256i zeroed = _mm256_and_si256(alive, _mm256_set_epi32(
+                      0x00000000, 0xffffffff,
+                      0xffffffff, 0xffffffff,
+                      0xffffffff, 0xffffffff,
+                      0xffffffff, 0xffffffff));
+          __m256i bulk, indices, remaining;
+
+          switch (dy) {
+          case 1:
+            bulk = _mm256_slli_epi64(alive, 4);
+            last = _mm256_set_epi32(0,0,0,0,0,0,0,_mm256_extract_epi32(last, 0));
+            indices = _mm256_set_epi32(0,2,0,4,0,6,0,0);
+            remaining = _mm256_permutevar8x32_epi32(zeroed, indices);
+            remaining = _mm256_srli_epi32(_mm256_or_si256(remaining, last), 28);
+            remaining = _mm256_and_si256(remaining, _mm256_set1_epi64x(1));
+            alive = _mm256_or_si256(bulk, remaining);
+            break;
+          case -1:
+            bulk = _mm256_srli_epi64(alive, 4);
+            last = _mm256_set_epi32(_mm256_extract_epi32(last, 7),0,0,0,0,0,0,0);
+            indices = _mm256_set_epi32(0,0,1,0,3,0,5,0);
+            remaining = _mm256_permutevar8x32_epi32(zeroed, indices);
+            remaining = _mm256_slli_epi32(_mm256_or_si256(remaining, last), 28);
+            remaining = _mm256_and_si256(remaining, _mm256_set1_epi64x(0x1000000000000000));
+            alive = _mm256_or_si256(bulk, remaining);
+            break;
+          }
+
+          out[y] = _mm256_add_epi8(out[y], alive);
+        }
+      }
     }
   }
 }
 
+void updateRow(__m256i *row, const __m256i *neighbors) {
+  for (int y = 0; y < cols; ++y) {
+    row[y] = next(row[y], neighbors[y]);
+  }
+}
+
 void nextGeneration() {
+  std::copy(cells[rows - 1], cells[rows - 1] + cols, above);
+  std::copy(cells[0], cells[0] + cols, first_row);
+
   for (int x = 0; x < rows; ++x) {
-    for (int y = 0; y < cols; ++y) {
-      neighbors[x][y] = _mm256_setzero_si256();
-      for (int dx = -1; dx <= 1; ++dx) {
-        for (int dy = -1; dy <= 1; ++dy) {
-          if (dx != 0 || dy != 0) {
-            int nx = (rows + x + dx) % rows;
-            int ny = (cols + y + dy) % cols;
-            __m256i alive = cells[nx][y];
-            __m256i last = cells[nx][ny];
-            __m256i zeroed = _mm256_and_si256(alive, _mm256_set_epi32(
-                        0x00000000, 0xffffffff,
-                        0xffffffff, 0xffffffff,
-                        0xffffffff, 0xffffffff,
-                        0xffffffff, 0xffffffff));
-            __m256i bulk, indices, remaining;
-
-            switch (dy) {
-            case 1:
-              bulk = _mm256_slli_epi64(alive, 4);
-              last = _mm256_set_epi32(0,0,0,0,0,0,0,_mm256_extract_epi32(last, 0));
-              indices = _mm256_set_epi32(0,2,0,4,0,6,0,0);
-              remaining = _mm256_permutevar8x32_epi32(zeroed, indices);
-              remaining = _mm256_srli_epi32(_mm256_or_si256(remaining, last), 28);
-              remaining = _mm256_and_si256(remaining, _mm256_set1_epi64x(1));
-              alive = _mm256_or_si256(bulk, remaining);
-              break;
-            case -1:
-              bulk = _mm256_srli_epi64(alive, 4);
-              last = _mm256_set_epi32(_mm256_extract_epi32(last, 7),0,0,0,0,0,0,0);
-              indices = _mm256_set_epi32(0,0,1,0,3,0,5,0);
-              remaining = _mm256_permutevar8x32_epi32(zeroed, indices);
-              remaining = _mm256_slli_epi32(_mm256_or_si256(remaining, last), 28);
-              remaining = _mm256_and_si256(remaining, _mm256_set1_epi64x(0x1000000000000000));
-              alive = _mm256_or_si256(bulk, remaining);
-              break;
-            }
-
-            neighbors[x][y] = _mm256_add_epi8(neighbors[x][y], alive);
-          }
-        }
-      }
-    }
+    std::copy(cells[x], cells[x] + cols, here);
+    const __m256i *below = x + 1 < rows ? cells[x + 1] : first_row;
+    rowNeighbors(above, here, below, counts);
+    updateRow(cells[x], counts);
+    std::swap(above, here);
   }
-
-  updateCells();
 }
 
 int main(void) {
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include "ctpl_stl.h"
+#include <iostream>
+#include <thread>
+
+constexpr int rows = 1 << 12;
+constexpr int cols = rows / 64;
+constexpr int gens = 200;
+constexpr int threads = 2;
+constexpr int batch = rows / threads;
+constexpr int readers = 2;
+
+// Generations are published so that other threads can read a consistent
+// board while the stepper keeps going. The stepper only ever writes into a
+// board that is neither published nor pinned by a reader, so a snapshot is
+// never modified while it is held. Each reader pins at most one board at a
+// time, so with a board for each of them on top of the published one and the
+// one being written, the stepper only has to wait if more threads read than
+// were planned for.
+struct Board {
+  uint64_t cells[rows][cols];
+  uint64_t generation;
+  std::atomic<int> pins;
+};
+
+Board boards[readers + 2];
+std::atomic<Board *> published(&boards[0]);
+std::atomic<uint64_t> stepper_waits(0);
+std::atomic<uint64_t> snapshots_read(0);
+std::atomic<uint64_t> last_live(0);
+std::atomic<bool> done(false);
+
+void randomizeCells() {
+  auto cells = published.load()->cells;
+  for (int x = 0; x < rows; ++x) {
+    for (int y = 0; y < cols; ++y) {
+      for (int i = 0; i < 8; ++i) {
+        cells[x][y] = (cells[x][y] << 8) | (rand() & 0xff);
+      }
+    }
+  }
+}
+
+// Pins the latest published generation. The board stays unchanged until it
+// is handed back with releaseSnapshot().
+Board *acquireSnapshot() {
+  while (true) {
+    Board *board = published.load();
+    board->pins.fetch_add(1);
+    // The stepper may have retired and started overwriting the board between
+    // the load and the pin; only keep it if it is still the published one.
+    if (published.load() == board) {
+      return board;
+    }
+    board->pins.fetch_sub(1);
+  }
+}
+
+void releaseSnapshot(Board *board) {
+  board->pins.fetch_sub(1);
+}
+
+void printCells() {
+  Board *board = acquireSnapshot();
+  std::cout << "\033[H\033[2J";
+  for (int x = 0; x < rows && x < 16; ++x) {
+    for (int y = 0; y < 16; ++y) {
+      bool on = ((board->cells[x][0] >> uint(63-y))&1) == 1;
+      std::cout << (on ? "o" : " ");
+    }
+    std::cout << std::endl;
+  }
+  releaseSnapshot(board);
+}
+
+uint64_t liveCells(const Board *board) {
+  uint64_t live = 0;
+  for (int x = 0; x < rows; ++x) {
+    for (int y = 0; y < cols; ++y) {
+      live += __builtin_popcountll(board->cells[x][y]);
+    }
+  }
+  return live;
+}
+
+void readCells() {
+  while (!done.load()) {
+    Board *board = acquireSnapshot();
+    last_live.store(liveCells(board));
+    releaseSnapshot(board);
+    snapshots_read.fetch_add(1);
+  }
+}
+
+void nextRow(const uint64_t *above, const uint64_t *here, const uint64_t *below, uint64_t *out) {
+  const uint64_t *neighborhood[3] = {above, here, below};
+
+  for (int x = 0; x < cols; ++x) {
+    uint64_t b1 = 0, b2 = 0, b4 = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (dx != 0 || dy != 0) {
+          int nx = (cols + x + dx) % cols;
+          uint64_t alive = neighborhood[dy + 1][x];
+          uint64_t last = neighborhood[dy + 1][nx];
+
+          switch (dx) {
+          case 1:
+            alive <<= 1;
+            last >>= 63;
+            alive |= last;
+            break;
+          case -1:
+            alive >>= 1;
+            last <<= 63;
+            alive |= last;
+            break;
+          }
+
+          uint64_t c2 = alive & b1;
+          uint64_t c4 = c2 & b2;
+          b1 ^= alive;
+          b2 ^= c2;
+          b4 |= c4;
+        }
+      }
+    }
+
+    out[x] = b2 & (b1 | here[x]) & ~b4;
+  }
+}
+
+// Finds a board that is neither the source of the next generation nor pinned
+// by a reader, yielding until one frees up.
+Board *unusedBoard(const Board *source) {
+  bool waited = false;
+  while (true) {
+    for (Board &board : boards) {
+      if (&board != source && board.pins.load() == 0) {
+        return &board;
+      }
+    }
+    if (!waited) {
+      stepper_waits.fetch_add(1);
+      waited = true;
+    }
+    std::this_thread::yield();
+  }
+}
+
+void nextGeneration(ctpl::thread_pool &p) {
+  std::vector<std::future<void>> results(threads);
+  Board *source = published.load();
+  Board *target = unusedBoard(source);
+
+  for (int i = 0; i < threads; i++) {
+    int row_start = i * batch;
+    results[i] = p.push([source, target, row_start](int){
+      for (int y = row_start; y < row_start + batch; ++y) {
+        nextRow(source->cells[(rows + y - 1) % rows], source->cells[y],
+                source->cells[(y + 1) % rows], target->cells[y]);
+      }
+    });
+  }
+
+  for (int i = 0; i < threads; ++i) {
+    results[i].get();
+  }
+
+  target->generation = source->generation + 1;
+  published.store(target);
+}
+
+int main(void) {
+  randomizeCells();
+
+  ctpl::thread_pool p(threads);
+  std::vector<std::thread> reader_threads;
+  for (int i = 0; i < readers; ++i) {
+    reader_threads.emplace_back(readCells);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < gens; ++i) {
+    nextGeneration(p);
+  }
+
+  auto stop = std::chrono::steady_clock::now();
+  done.store(true);
+  for (auto &reader : reader_threads) {
+    reader.join();
+  }
+
+  float seconds = std::chrono::duration<float>(stop - start).count();
+  float efficiency = float(long(rows) * rows * gens) / seconds;
+  std::cout << "C++ Efficiency in cellhz: " << efficiency << std::endl;
+  std::cout << "Snapshots read: " << snapshots_read.load()
+            << " (last saw " << last_live.load() << " live cells)" << std::endl;
+  std::cout << "Stepper waits: " << stepper_waits.load() << " of " << gens << " generations" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+constexpr int board_shift = 14;
+constexpr int rows = 1 << board_shift;
+constexpr int cols = rows / 64;
+constexpr int gens = 40;
+constexpr int gens_per_frame = 4;
+
+// Every generation marks the tiles of 64x64 cells (one word wide) that it
+// changed. Between frames only those tiles are folded into a pyramid of live
+// cell counts, whose level 0 counts 16x16 blocks and every level above sums
+// 2x2 blocks of the one below, up to the whole board.
+constexpr int tile = 64;
+constexpr int tile_rows = rows / tile;
+constexpr int base_shift = 4;
+constexpr int levels = board_shift - base_shift + 1;
+
+uint64_t cells[rows][cols];
+uint8_t dirty[tile_rows][cols];
+std::vector<uint32_t> pyramid[levels];
+
+uint64_t row1[cols];
+uint64_t row2[cols];
+uint64_t first_row[cols];
+auto above = row1;
+auto here = row2;
+
+void randomizeCells() {
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < cols; ++x) {
+      for (int i = 0; i < 8; ++i) {
+        cells[y][x] = (cells[y][x] << 8) | (rand() & 0xff);
+      }
+    }
+  }
+  std::fill(&dirty[0][0], &dirty[0][0] + tile_rows * cols, 1);
+}
+
+void nextRow(const uint64_t *above, const uint64_t *here, const uint64_t *below, uint64_t *out, uint8_t *changed) {
+  const uint64_t *neighborhood[3] = {above, here, below};
+
+  for (int x = 0; x < cols; ++x) {
+    uint64_t b1 = 0, b2 = 0, b4 = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (dx != 0 || dy != 0) {
+          int nx = (cols + x + dx) % cols;
+          uint64_t alive = neighborhood[dy + 1][x];
+          uint64_t last = neighborhood[dy + 1][nx];
+
+          switch (dx) {
+          case 1:
+            alive <<= 1;
+            last >>= 63;
+            alive |= last;
+            break;
+          case -1:
+            alive >>= 1;
+            last <<= 63;
+            alive |= last;
+            break;
+          }
+
+          uint64_t c2 = alive & b1;
+          uint64_t c4 = c2 & b2;
+          b1 ^= alive;
+          b2 ^= c2;
+          b4 |= c4;
+        }
+      }
+    }
+
+    out[x] = b2 & (b1 | here[x]) & ~b4;
+    changed[x] |= out[x] != here[x];
+  }
+}
+
+void nextGeneration() {
+  std::copy(cells[rows - 1], cells[rows - 1] + cols, above);
+  std::copy(cells[0], cells[0] + cols, first_row);
+
+  for (int y = 0; y < rows; ++y) {
+    std::copy(cells[y], cells[y] + cols, here);
+    const uint64_t *below = y + 1 < rows ? cells[y + 1] : first_row;
+    nextRow(above, here, below, cells[y], dirty[y / tile]);
+    std::swap(above, here);
+  }
+}
+
+int levelSide(int level) {
+  return rows >> (base_shift + level);
+}
+
+// Brings the pyramid up to date with the board, touching only the blocks
+// that lie in tiles changed since the last update.
+void updatePyramid() {
+  constexpr int block = 1 << base_shift;
+  constexpr int blocks_per_tile = tile / block;
+  int side = levelSide(0);
+  pyramid[0].resize(side * side);
+
+  for (int ty = 0; ty < tile_rows; ++ty) {
+    for (int tx = 0; tx < cols; ++tx) {
+      if (!dirty[ty][tx]) {
+        continue;
+      }
+      for (int by = 0; by < blocks_per_tile; ++by) {
+        for (int bx = 0; bx < blocks_per_tile; ++bx) {
+          uint32_t live = 0;
+          for (int r = 0; r < block; ++r) {
+            uint64_t word = cells[ty * tile + by * block + r][tx];
+            live += __builtin_popcountll((word >> (64 - block * (bx + 1))) & ((uint64_t(1) << block) - 1));
+          }
+          pyramid[0][(ty * blocks_per_tile + by) * side + tx * blocks_per_tile + bx] = live;
+        }
+      }
+    }
+  }
+
+  std::vector<uint8_t> changed;
+  for (int level = 1; level < levels; ++level) {
+    int side = levelSide(level);
+    int below_side = levelSide(level - 1);
+    pyramid[level].resize(side * side);
+    changed.assign(side * side, 0);
+
+    // A tile spans blocks_per_tile >> level blocks at the finer levels and
+    // a single block at the coarser ones.
+    int span = std::max(blocks_per_tile >> level, 1);
+    for (int ty = 0; ty < tile_rows; ++ty) {
+      for (int tx = 0; tx < cols; ++tx) {
+        if (!dirty[ty][tx]) {
+          continue;
+        }
+        int y0 = (ty * blocks_per_tile) >> level;
+        int x0 = (tx * blocks_per_tile) >> level;
+        for (int y = y0; y < y0 + span; ++y) {
+          std::fill(&changed[y * side + x0], &changed[y * side + x0] + span, 1);
+        }
+      }
+    }
+
+    const uint32_t *finer = pyramid[level - 1].data();
+    for (int y = 0; y < side; ++y) {
+      for (int x = 0; x < side; ++x) {
+        if (changed[y * side + x]) {
+          pyramid[level][y * side + x] =
+            finer[(2 * y) * below_side + 2 * x] + finer[(2 * y) * below_side + 2 * x + 1] +
+            finer[(2 * y + 1) * below_side + 2 * x] + finer[(2 * y + 1) * below_side + 2 * x + 1];
+        }
+      }
+    }
+  }
+
+  std::fill(&dirty[0][0], &dirty[0][0] + tile_rows * cols, 0);
+}
+
+// Renders a width x height image whose pixels each cover a square of
+// 1 << zoom cells, starting from cell (top, left) rounded down to the pixel
+// grid and wrapping around the board. Pixels hold the live cell density,
+// from 0 for empty to 255 for full. Zooms coarser than the pyramid's base
+// blocks are read from the pyramid, finer ones straight from the board, and
+// zooms coarser than the whole board are clamped to one pixel per board.
+void renderViewport(int top, int left, int width, int height, int zoom, uint8_t *out) {
+  zoom = std::clamp(zoom, 0, board_shift);
+  top = (top % rows + rows) % rows;
+  left = (left % rows + rows) % rows;
+  int scale = 1 << zoom;
+  uint64_t full = uint64_t(scale) * scale;
+
+  if (zoom >= base_shift) {
+    int level = zoom - base_shift;
+    int side = levelSide(level);
+    const uint32_t *counts = pyramid[level].data();
+    for (int py = 0; py < height; ++py) {
+      int y = ((top >> zoom) + py) % side;
+      for (int px = 0; px < width; ++px) {
+        int x = ((left >> zoom) + px) % side;
+        out[py * width + px] = uint64_t(counts[y * side + x]) * 255 / full;
+      }
+    }
+    return;
+  }
+
+  uint64_t mask = (uint64_t(1) << scale) - 1;
+  for (int py = 0; py < height; ++py) {
+    int y0 = (((top >> zoom) + py) << zoom) % rows;
+    for (int px = 0; px < width; ++px) {
+      int x0 = (((left >> zoom) + px) << zoom) % rows;
+      uint32_t live = 0;
+      for (int r = y0; r < y0 + scale; ++r) {
+        live += __builtin_popcountll((cells[r][x0 / 64] >> (64 - scale - x0 % 64)) & mask);
+      }
+      out[py * width + px] = live * 255 / full;
+    }
+  }
+}
+
+bool writePGM(const char *path, const uint8_t *image, int width, int height) {
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  fprintf(file, "P5\n%d %d\n255\n", width, height);
+  bool ok = fwrite(image, 1, size_t(width) * height, file) == size_t(width) * height;
+  return fclose(file) == 0 && ok;
+}
+
+int main(void) {
+  randomizeCells();
+
+  constexpr int overview_zoom = 6;
+  constexpr int overview = rows >> overview_zoom;
+  constexpr int closeup = 256;
+  std::vector<uint8_t> overview_image(overview * overview);
+  std::vector<uint8_t> closeup_image(closeup * closeup);
+
+  using clock = std::chrono::steady_clock;
+  clock::duration stepping(0), rendering(0);
+
+  for (int i = 0; i < gens; i += gens_per_frame) {
+    auto start = clock::now();
+    for (int j = 0; j < gens_per_frame; ++j) {
+      nextGeneration();
+    }
+    auto stepped = clock::now();
+    updatePyramid();
+    renderViewport(0, 0, overview, overview, overview_zoom, overview_image.data());
+    renderViewport(rows / 2, rows / 2, closeup, closeup, 0, closeup_image.data());
+    auto rendered = clock::now();
+
+    stepping += stepped - start;
+    rendering += rendered - stepped;
+  }
+
+  if (!writePGM("overview.pgm", overview_image.data(), overview, overview) ||
+      !writePGM("closeup.pgm", closeup_image.data(), closeup, closeup)) {
+    std::cerr << "Could not write viewport images" << std::endl;
+    return 1;
+  }
+
+  int frames = gens / gens_per_frame;
+  float step_seconds = std::chrono::duration<float>(stepping).count();
+  float render_ms = std::chrono::duration<float, std::milli>(rendering).count() / frames;
+  std::cout << "C++ Efficiency in cellhz: " << float(long(rows) * rows * gens) / step_seconds << std::endl;
+  std::cout << "Average pyramid update and render per frame: " << render_ms << " ms" << std::endl;
+
+  return 0;
+}